@@ -0,0 +1,63 @@
+#include "Board.hpp"
+
+static inline size_t round_up(size_t n, size_t to) {
+    return (n + to - 1) / to * to;
+}
+
+Board::Board(): cells(nullptr), bytes(0), stride(0), height(0), row_width(0), mapping(NONE){}
+
+Board::~Board() {
+    release();
+}
+
+void Board::allocate(uint h, uint w) {
+    release();
+    height = h;
+    row_width = w;
+    stride = round_up(w, BOARD_ALIGNMENT / sizeof(uint));
+    bytes = (size_t)height * stride * sizeof(uint);
+    if (bytes == 0)
+        return;
+
+    /* Big boards try, in order:
+     * 1. Explicit huge pages (MAP_HUGETLB), only available if the admin reserved some.
+     * 2. Transparent huge pages: a 2 MB aligned buffer the kernel is advised to back with huge pages.
+     * Small boards (and a refused madvise) fall back to a plain cache line aligned buffer.
+     */
+    if (bytes >= HUGE_PAGE_SIZE) {
+        size_t huge_bytes = round_up(bytes, HUGE_PAGE_SIZE);
+        void* p = mmap(nullptr, huge_bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            cells = (uint*)p;
+            bytes = huge_bytes;
+            mapping = HUGETLB;
+            return;
+        }
+        if (posix_memalign(&p, HUGE_PAGE_SIZE, huge_bytes) == 0) {
+            cells = (uint*)p;
+            bytes = huge_bytes;
+            mapping = madvise(p, huge_bytes, MADV_HUGEPAGE) == 0 ? TRANSPARENT : ALIGNED;
+            return;
+        }
+    }
+
+    void* p = nullptr;
+    if (posix_memalign(&p, BOARD_ALIGNMENT, bytes) != 0)
+        throw std::bad_alloc(); // Like the vectors boards used to be - the server reports it to the client only
+    cells = (uint*)p;
+    mapping = ALIGNED;
+}
+
+void Board::prefault(uint row_start, uint row_end) {
+    std::fill(cells + (size_t)row_start * stride, cells + (size_t)row_end * stride, 0u);
+}
+
+void Board::release() {
+    if (mapping == HUGETLB)
+        munmap(cells, bytes);
+    else if (mapping != NONE)
+        free(cells);
+    cells = nullptr;
+    mapping = NONE;
+}
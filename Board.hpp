@@ -0,0 +1,55 @@
+#ifndef __BOARD_H
+#define __BOARD_H
+#include "Headers.hpp"
+
+#define BOARD_ALIGNMENT 64 // Cache line, and wide enough for any SIMD load of a row
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024) // 2 MB huge pages, used for boards at least this big
+
+/*--------------------------------------------------------------------------------
+									Board Storage
+--------------------------------------------------------------------------------*/
+// A game board stored as a single contiguous buffer, so a generation walks
+// a handful of huge pages instead of one heap block per row.
+// Each row starts on a BOARD_ALIGNMENT boundary (rows are padded up to it).
+class Board {
+public:
+	// A view of a single row, so board[i][j] reads the same as with nested vectors
+	class Row {
+	public:
+		Row(uint* cells, uint width): cells(cells), width(width){}
+		uint& operator[](uint j) const { return cells[j]; }
+		uint* data() const { return cells; }
+		uint size() const { return width; }
+	private:
+		uint* cells;
+		uint width;
+	};
+
+	Board();
+	~Board();
+	Board(const Board&) = delete;
+	Board& operator=(const Board&) = delete;
+
+	// Reserves the storage without touching it. Pages are faulted in later by prefault(),
+	// so each one is first touched by the thread that is going to work on it.
+	void allocate(uint height, uint width);
+	void prefault(uint row_start, uint row_end); // Zeroes rows [row_start, row_end)
+
+	Row operator[](uint i) const { return Row(cells + (size_t)i * stride, row_width); }
+	uint size() const { return height; } // Number of rows
+
+private:
+	// How the buffer was obtained, so ~Board can give it back the same way
+	enum Mapping { NONE, HUGETLB, TRANSPARENT, ALIGNED };
+
+	void release();
+
+	uint* cells;
+	size_t bytes;
+	size_t stride; // Distance between rows, in cells
+	uint height;
+	uint row_width;
+	Mapping mapping;
+};
+
+#endif
@@ -8,52 +8,86 @@ static const char *colors[7] = {BLACK, RED, GREEN, YELLOW, BLUE, MAGENTA, CYAN};
 void Game::run() {
 
 	_init_game(); // Starts the threads and all other variables you need
+	m_history.capture(0, *game_matrix_curr);
 	print_board("Initial Board");
-	for (uint i = 0; i < m_gen_num; ++i) {
+	for (uint i = 0; i < m_gen_num && !m_cancelled; ++i) {
 		auto gen_start = std::chrono::system_clock::now();
 		_step(i); // Iterates a single generation 
+		m_history.capture(i + 1, *game_matrix_curr); // Part of the generation's time: copies the tiles _step changed
 		auto gen_end = std::chrono::system_clock::now();
 		m_gen_hist.push_back((float)std::chrono::duration_cast<std::chrono::microseconds>(gen_end - gen_start).count());
+		write_species_stats(i);
 		print_board(nullptr);
 	} // generation loop
 	print_board("Final Board");
+	save_region_board();
 	_destroy_game();
 }
 
 void Game::_init_game() {
-    initialize_game_matrix();
+    if (owns_threads)
+        perf_counters.start(); // Before the threads are created, so they inherit the counters
+    vector<string> lines = board_lines.empty() ? utils::read_lines(filename) : board_lines;
+    user_error(string("Empty board: ") + filename, !lines.empty());
+    set_light_cone(lines.size(), utils::split(lines[0], DEF_MAT_DELIMITER).size());
+    matrix_height = cone.height;
+    matrix_width = cone.width;
+    game_matrix_curr->allocate(matrix_height, matrix_width);
+    game_matrix_next->allocate(matrix_height, matrix_width);
+    m_history.reset(matrix_height, matrix_width);
+
     m_thread_num = non_effective_thread_num > matrix_height ? matrix_height: non_effective_thread_num;
     //jobs_queue = new PCQueue<Job>;
     //completed_jobs = 0;
     pthread_mutex_init(&mtx, nullptr);
+    context = job_context{game_matrix_curr, game_matrix_next, &m_tile_hist, &mtx, &completed_jobs,
+                          m_region.row - cone.row, m_region.row - cone.row + m_region.height,
+                          m_region.col - cone.col, m_region.col - cone.col + m_region.width,
+                          m_history.change_flags(), m_history.tile_columns(), HISTORY_TILE_SIZE};
+
+    if (!species_filename.empty()) {
+        species_file.open(species_filename, std::ofstream::out | std::ofstream::trunc);
+        user_error(string("Invalid file: ") + species_filename, species_file.good());
+        species_file << "Gen,Births,Deaths";
+        for (int s = 1; s <= MAX_SPECIE; ++s) {
+            species_file << ",Specie_" << s;
+        }
+        species_file << endl;
+    }
     
-    for(uint i = 0; i < m_thread_num; i++){
-		GameThread* gh = new GameThread(i, &jobs_queue, &m_tile_hist,
-			&mtx, game_matrix_curr, game_matrix_next, &completed_jobs); 
+    for(uint i = 0; i < m_thread_num && owns_threads; i++){
+        own_jobs_queues.emplace_back();
+        jobs_queues.push_back(&own_jobs_queues.back());
+		GameThread* gh = new GameThread(i, jobs_queues[i]);
         m_threadpool.push_back(gh);
         gh->start();
     }
+    assert(jobs_queues.size() >= m_thread_num);
+
+    // Tile i always goes to jobs_queues[i], so each thread faults in the pages of the rows it works on
+    fill_jobs_queue(PREFAULT, nullptr);
+    for(uint i = 0; i < m_thread_num; i++){
+        completed_jobs.down();
+    }
+    initialize_game_matrix(lines);
     //cout << matrix_height << "," << matrix_width << endl;
 }
 
 void Game::_step(uint curr_gen) {
     //completed_jobs = 0;
-    fill_jobs_queue(0, false); // push jobs for phase one
+    m_curr_stats = gen_stats(); // The jobs of this generation reduce their tiles' counters into it
+    fill_jobs_queue(PHASE_ONE, &m_curr_stats); // push jobs for phase one
 	
     for(int i = 0; i < m_thread_num; i++){
 		completed_jobs.down();
 	}// waiting for phase one to complete
 
     //completed_jobs = 0;
-    bool end = false;
-    if(curr_gen == m_gen_num - 1){
-        end = true;
-    }
-    
-    fill_jobs_queue(1, end); // push jobs for phase two
+    fill_jobs_queue(PHASE_TWO, &m_curr_stats); // push jobs for phase two
     for(int i = 0; i < m_thread_num; i++){
 		completed_jobs.down();
 	}// waiting for phase two to complete
+    m_species_hist.push_back(m_curr_stats);
     
     /* Instead of swapping between matrices for two times at each _step call
      * I implemented thread_workload to work on the current board in phase 1
@@ -64,23 +98,37 @@ void Game::_step(uint curr_gen) {
 }
 
 void Game::_destroy_game(){
-    for (uint i = 0; i < m_thread_num; ++i) {
-        m_threadpool[i]->join();
+    if (owns_threads) {
+        for (uint i = 0; i < m_thread_num; ++i) {
+            jobs_queues[i]->push(new Job(tuple<int, int>{0, 0}, matrix_height, matrix_width, EXIT, nullptr, nullptr));
+        }
+        for (uint i = 0; i < m_thread_num; ++i) {
+            m_threadpool[i]->join();
+        }
+        perf_counters.stop(); // The joined threads' counts are now folded into ours
     }
 
     for(auto &thread: this->m_threadpool){
         delete thread;
     }
 
-    delete game_matrix_curr;
-    delete game_matrix_next;
     pthread_mutex_destroy(&mtx);
+    if (species_file.is_open())
+        species_file.close();
 }
 
 /*--------------------------------------------------------------------------------
 
 --------------------------------------------------------------------------------*/
 inline void Game::print_board(const char* header) {
+    // Only the requested region is printed, it sits at (row_offset, col_offset) inside the simulated cone
+    uint row_offset = m_region.row - cone.row;
+    uint col_offset = m_region.col - cone.col;
+    print_region(header, [&](uint i, uint j) { return (*game_matrix_curr)[row_offset + i][col_offset + j]; });
+}
+
+template <typename CellAt>
+void Game::print_region(const char* header, CellAt cell_at) {
 
 	if(print_on){ 
 
@@ -92,18 +140,18 @@ inline void Game::print_board(const char* header) {
 		if (header != NULL)
 			cout << "<------------" << header << "------------>" << endl;
 
-        cout << u8"╔" << string(u8"═") * matrix_width << u8"╗" << endl;
-        for (uint i = 0; i < matrix_height; ++i) {
+        cout << u8"╔" << string(u8"═") * m_region.width << u8"╗" << endl;
+        for (uint i = 0; i < m_region.height; ++i) {
             cout << u8"║";
-            for (uint j = 0; j < matrix_width; ++j) {
-                if ((*game_matrix_curr)[i][j] > 0)
-                    cout << colors[(*game_matrix_curr)[i][j] % 7] << u8"█" << RESET;
+            for (uint j = 0; j < m_region.width; ++j) {
+                if (cell_at(i, j) > 0)
+                    cout << colors[cell_at(i, j) % 7] << u8"█" << RESET;
                 else
                     cout << u8"░";
             }
             cout << u8"║" << endl;
         }
-        cout << u8"╚" << string(u8"═") * matrix_width << u8"╝" << endl;
+        cout << u8"╚" << string(u8"═") * m_region.width << u8"╝" << endl;
 
 		// Display for GEN_SLEEP_USEC micro-seconds on screen 
 		if(interactive_on)
@@ -116,17 +164,83 @@ inline void Game::print_board(const char* header) {
 Game::Game(game_params params): m_gen_num(params.n_gen), m_thread_num(params.n_thread),
                 interactive_on(params.interactive_on),
                 print_on(params.print_on), non_effective_thread_num(params.n_thread),
-                filename(params.filename), completed_jobs(){
-    game_matrix_curr = new vector<vector<uint>>;
-    game_matrix_next = new vector<vector<uint>>;
+                filename(params.filename), owns_threads(true),
+                m_cancelled(false), board_lines(std::move(params.board_lines)), completed_jobs(),
+                species_filename(params.species_filename), m_region(params.roi),
+                m_history(params.history_depth){
+    game_matrix_curr = new Board;
+    game_matrix_next = new Board;
 }
 
-Game::~Game() {}
+Game::Game(game_params params, const vector<PCQueue<Job*>*>& shared_jobs_queues): Game(std::move(params)) {
+    jobs_queues = shared_jobs_queues;
+    owns_threads = false;
+}
+
+Game::~Game() {
+    delete game_matrix_curr;
+    delete game_matrix_next;
+}
 
 uint Game::thread_num() const {
     return this->m_thread_num;
 }
 
+void Game::cancel() {
+    m_cancelled = true;
+}
+
+bool Game::cancelled() const {
+    return m_cancelled;
+}
+
+const History& Game::history() const {
+    return m_history;
+}
+
+bool Game::seek(uint gen) {
+    if (!m_history.contains(gen))
+        return false;
+    const History::Snapshot& snapshot = m_history.at(gen);
+    uint row_offset = m_region.row - cone.row;
+    uint col_offset = m_region.col - cone.col;
+    auto cell_at = [&](uint i, uint j) { return m_history.cell(snapshot, row_offset + i, col_offset + j); };
+    save_region_board(cell_at);
+    print_region((string("Generation ") + std::to_string(gen)).c_str(), cell_at);
+    return true;
+}
+
+game_params Game::resume_params(uint gen, uint n_gen) const {
+    assert(m_history.contains(gen));
+    game_params g;
+    g.n_gen = n_gen;
+    g.n_thread = non_effective_thread_num;
+    g.interactive_on = interactive_on;
+    g.print_on = print_on;
+    g.roi = region{m_region.row - cone.row, m_region.col - cone.col, m_region.height, m_region.width};
+    g.board_lines = m_history.board_lines(gen);
+    g.history_depth = 0;
+    return g;
+}
+
+void Game::save_region_board() {
+    uint row_offset = m_region.row - cone.row;
+    uint col_offset = m_region.col - cone.col;
+    save_region_board([&](uint i, uint j) { return (*game_matrix_curr)[row_offset + i][col_offset + j]; });
+}
+
+template <typename CellAt>
+void Game::save_region_board(CellAt cell_at) {
+    m_region_board.clear();
+    for (uint i = 0; i < m_region.height; ++i) {
+        vector<uint> row(m_region.width);
+        for (uint j = 0; j < m_region.width; ++j) {
+            row[j] = cell_at(i, j);
+        }
+        m_region_board.push_back(row);
+    }
+}
+
 const vector<double> Game::gen_hist() const {
     return m_gen_hist;
 }
@@ -135,36 +249,84 @@ const vector<double> Game::tile_hist() const {
     return m_tile_hist;
 }
 
-void Game::initialize_game_matrix() {
-    vector<string> lines = utils::read_lines(filename);
-    for(auto& it: lines){
-        vector<string> rows = utils::split(it, DEF_MAT_DELIMITER);
-        vector<uint> elements = vector<uint>();
-        for(uint i = 0; i < rows.size(); i++){
-            elements.push_back(std::stoi(rows[i]));
+const vector<gen_stats> Game::species_hist() const {
+    return m_species_hist;
+}
+
+const vector<vector<uint>> Game::region_board() const {
+    return m_region_board;
+}
+
+long long Game::page_faults() const {
+    return perf_counters.page_faults();
+}
+
+long long Game::tlb_misses() const {
+    return perf_counters.tlb_misses();
+}
+
+void Game::write_species_stats(uint gen) {
+    if (!species_file.is_open())
+        return;
+    const gen_stats& stats = m_species_hist[gen];
+    species_file << gen + 1 << "," << stats.births << "," << stats.deaths;
+    for (int s = 1; s <= MAX_SPECIE; ++s) {
+        species_file << "," << stats.population[s];
+    }
+    species_file << "\n"; // One row per generation, the stream's buffer batches the actual writes
+}
+
+/* A cell's state after one generation depends on its 3x3 neighborhood in phase 1,
+ * and again on a 3x3 neighborhood in phase 2 - so information travels at most
+ * LIGHT_CONE_RADIUS cells per generation.
+ * Simulating only the window grown by m_gen_num * LIGHT_CONE_RADIUS on each side
+ * (clipped to the board) yields the exact window after m_gen_num generations:
+ * the cells at the cut edges are wrong, but the error does not reach the window in time.
+ */
+void Game::set_light_cone(uint board_height, uint board_width) {
+    if (m_region.height == 0 || m_region.width == 0) {
+        m_region = region{0, 0, board_height, board_width};
+    }
+    // Written so that nothing wraps around, whatever the region's values
+    user_error("Region is out of the board",
+               (m_region.row < board_height && m_region.height <= board_height - m_region.row &&
+                m_region.col < board_width && m_region.width <= board_width - m_region.col));
+
+    uint64_t margin = (uint64_t)m_gen_num * LIGHT_CONE_RADIUS;
+    uint64_t bottom = min<uint64_t>(board_height, (uint64_t)m_region.row + m_region.height + margin);
+    uint64_t right = min<uint64_t>(board_width, (uint64_t)m_region.col + m_region.width + margin);
+    cone.row = m_region.row > margin ? m_region.row - margin : 0;
+    cone.col = m_region.col > margin ? m_region.col - margin : 0;
+    cone.height = bottom - cone.row;
+    cone.width = right - cone.col;
+}
+
+void Game::initialize_game_matrix(const vector<string>& lines) {
+    for(uint i = 0; i < matrix_height; i++){
+        vector<string> rows = utils::split(lines[cone.row + i], DEF_MAT_DELIMITER);
+        // The board is as wide as its first line, shorter lines are padded with dead cells
+        uint width = rows.size() > cone.col ? min((uint)rows.size() - cone.col, matrix_width) : 0;
+        for(uint j = 0; j < width; j++){
+            (*game_matrix_curr)[i][j] = std::stoi(rows[cone.col + j]);
+            (*game_matrix_next)[i][j] = (*game_matrix_curr)[i][j];
         }
-        game_matrix_curr->push_back(elements);
-        game_matrix_next->push_back(elements);
-        matrix_width = elements.size();
     }
-    matrix_height = game_matrix_curr->size();
-    //matrix_width = game_matrix_curr[0].size();
 }
 
 
-void Game::fill_jobs_queue(bool phase, bool end) {
+void Game::fill_jobs_queue(job_kind kind, gen_stats* stats) {
     assert(m_thread_num != 0);
     int rows_per_thread = matrix_height / m_thread_num;
     int remainder = matrix_height % m_thread_num;
 
     for(uint i = 0; i < m_thread_num - 1; i++){
         tuple<int, int> range{rows_per_thread * i, rows_per_thread * (i+1)};
-        Job* new_job = new Job(range, matrix_height, matrix_width, phase, end);
-        jobs_queue.push(new_job);
+        Job* new_job = new Job(range, matrix_height, matrix_width, kind, &context, stats);
+        jobs_queues[i]->push(new_job);
     }
 	tuple<int, int> remainder_range{rows_per_thread * (m_thread_num-1),
 									(rows_per_thread * (m_thread_num)) + remainder};
-	jobs_queue.push(new Job(remainder_range, matrix_height, matrix_width, phase, end));
+	jobs_queues[m_thread_num - 1]->push(new Job(remainder_range, matrix_height, matrix_width, kind, &context, stats));
 }
 
 
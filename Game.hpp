@@ -4,6 +4,9 @@
 #include "Thread.hpp"
 #include "PCQueue.hpp"
 #include "Job.h"
+#include "Board.hpp"
+#include "PerfCounters.hpp"
+#include "History.hpp"
 /*--------------------------------------------------------------------------------
 								  Species colors
 --------------------------------------------------------------------------------*/
@@ -20,6 +23,14 @@
 /*--------------------------------------------------------------------------------
 								  Auxiliary Structures
 --------------------------------------------------------------------------------*/
+struct region {
+	// A rectangle of the board, in cells. A zero height or width stands for the whole board.
+	uint row;
+	uint col;
+	uint height;
+	uint width;
+};
+
 struct game_params {
 	// All here are derived from ARGV, the program's input parameters. 
 	uint n_gen;
@@ -27,6 +38,12 @@ struct game_params {
 	string filename;
 	bool interactive_on; 
 	bool print_on; 
+	string species_filename; // Optional (empty = off): per generation species statistics are streamed into this CSV file
+	region roi; // Optional (zero size = off): only this window of the board is printed, returned and counted in the species
+	            // statistics. The timing histograms still cover all the simulated cells (see Game::set_light_cone)
+	vector<string> board_lines; // Optional (empty = off): the board itself, one line per row, used instead of reading filename
+	uint history_depth; // Optional (0 = off): the number of past generations kept for seek(), including the initial board
+	vector<uint> seek_gens; // Optional: retained generations main() prints again once the run is over
 };
 /*--------------------------------------------------------------------------------
 									Class Declaration
@@ -35,11 +52,29 @@ class Game {
 public:
 
 	Game(game_params);
+	// Runs on an already started pool of GameThreads, see Server.hpp. Tile i of every phase is pushed to
+	// shared_jobs_queues[i], so there must be at least as many queues as params.n_thread
+	Game(game_params, const vector<PCQueue<Job*>*>& shared_jobs_queues);
 	~Game();
 	void run(); // Runs the game
+	void cancel(); // Thread safe: run() returns after the generation in progress
 	const vector<double> gen_hist() const; // Returns the generation timing histogram
 	const vector<double> tile_hist() const; // Returns the tile timing histogram
+	const vector<gen_stats> species_hist() const; // Returns the per generation population, births and deaths
+	long long page_faults() const; // Returns the page faults taken during the run, -1 if the counter is unavailable
+	long long tlb_misses() const; // Returns the data TLB read misses during the run, -1 if the counter is unavailable
+	const vector<vector<uint>> region_board() const; // Returns the requested region (whole board by default) after the last generation
 	uint thread_num() const; //Returns the effective number of running threads = min(thread_num, field_height)
+	bool cancelled() const; // Returns true if cancel() was called
+	const History& history() const; // Returns the retained generations (the simulated part of the board, see set_light_cone)
+	// Prints a retained generation (0 = initial board) and makes its region the region_board(), reading
+	// only the region's cells from the history. The board itself is left as is. False if not retained
+	bool seek(uint gen);
+	// Parameters of a new Game continuing from retained generation gen for n_gen more generations: its board
+	// is that generation of the simulated cells (see History::board_lines) and its region the same window.
+	// With a region, the window is exact while gen + n_gen <= this game's generations (the light cone's size).
+	// The new game keeps the thread count and the print flags, with no species file and no history
+	game_params resume_params(uint gen, uint n_gen) const;
 	inline void print_board(const char* header);
 
 
@@ -55,6 +90,8 @@ protected: // All members here are protected, instead of private for testing pur
 	vector<double> m_tile_hist; 	 // Shared Timing history for tiles: First m_gen_num cells are the calculation durations for tiles in generation 1 and so on.
 							   	 // Note: In your implementation, all m_thread_num threads must write to this structure. 
 	vector<double> m_gen_hist;  	 // Timing history for generations: x=m_gen_hist[t] iff generation t was calculated in x microseconds
+	vector<gen_stats> m_species_hist; // Population history: m_species_hist[t] holds the counters of generation t, reduced from all tiles
+	gen_stats m_curr_stats; // Counters of the generation in progress, the jobs hold a pointer to it
 	vector<GameThread*> m_threadpool; // A storage container for your threads. This acts as the threadpool.
 
 	bool interactive_on; // Controls interactive mode - that means, prints the board as an animation instead of a simple dump to STDOUT 
@@ -63,17 +100,35 @@ protected: // All members here are protected, instead of private for testing pur
 	// TODO: Add in your variables and synchronization primitives
 	uint non_effective_thread_num;
     string filename;
-    vector<vector<uint>>* game_matrix_curr;
-    vector<vector<uint>>* game_matrix_next;
+    Board* game_matrix_curr;
+    Board* game_matrix_next;
     uint matrix_height;
     uint matrix_width;
 
-    PCQueue<Job*> jobs_queue;
+    std::deque<PCQueue<Job*>> own_jobs_queues; // One per thread of our own pool, a deque so they never move
+    vector<PCQueue<Job*>*> jobs_queues; // jobs_queues[i] gets tile i of every phase, and a single thread pops it
+    bool owns_threads;
+    std::atomic<bool> m_cancelled;
+    vector<string> board_lines;
     //int completed_jobs;
 	Semaphore completed_jobs;
+    job_context context; // Handed to the threads with every job
     pthread_mutex_t mtx;
+    string species_filename;
+    std::ofstream species_file;
+    PerfCounters perf_counters;
+    region m_region; // The requested window, in board coordinates
+    region cone; // The simulated part of the board: m_region grown by the light cone, see set_light_cone
+    vector<vector<uint>> m_region_board;
+    History m_history;
 
-    void initialize_game_matrix();
-    void fill_jobs_queue(bool phase, bool end);
+    void initialize_game_matrix(const vector<string>& lines);
+    void set_light_cone(uint board_height, uint board_width);
+    void fill_jobs_queue(job_kind kind, gen_stats* stats);
+    void write_species_stats(uint gen);
+    void save_region_board();
+    // Both take cell_at(i, j), returning cell (i, j) of the region
+    template <typename CellAt> void print_region(const char* header, CellAt cell_at);
+    template <typename CellAt> void save_region_board(CellAt cell_at);
 };
 #endif
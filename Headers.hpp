@@ -7,6 +7,9 @@
 #include <vector>
 #include <string>
 #include <queue>
+#include <deque>
+#include <set>
+#include <memory>
 #include <iterator>
 #include <tuple>
 
@@ -18,14 +21,28 @@
 // Utility
 #include <cmath>
 #include <cassert>
+#include <cstring>
 #include <chrono>
 #include <algorithm>
 #include <numeric>  
+#include <atomic>
 #include <unistd.h>
 
 // Threads & Synchronization 
 #include <pthread.h>
 
+// Memory & Performance counters
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Sockets & Event loop
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <signal.h>
+
 /*--------------------------------------------------------------------------------
 									   Typedefs
 --------------------------------------------------------------------------------*/
@@ -57,6 +74,8 @@ typedef vector<vector<bool>> bool_mat;
 #define GEN_SLEEP_USEC 300000 // Default : 300000. The approximate time the board is displayed each generation in micro-seconds
 #define DEF_MAT_DELIMITER ' ' // The seperator betweens 0s and 1s in your matrix input file 
 #define DEF_RESULTS_FILE_NAME "results.csv" // The filename of the results 
+#define MAX_SPECIE 7 // Species are numbered 1..7 (see the colors table in Game.hpp)
+#define LIGHT_CONE_RADIUS 2 // How far a cell's state can travel in one generation (phase 1 + phase 2)
 
 // Macros
 #define DEBUG 1
@@ -0,0 +1,110 @@
+#include "History.hpp"
+
+History::History(uint depth): depth(depth), height(0), width(0), tile_rows(0), tile_cols(0), first_gen(0){}
+
+void History::reset(uint h, uint w) {
+    height = h;
+    width = w;
+    tile_rows = (h + HISTORY_TILE_SIZE - 1) / HISTORY_TILE_SIZE;
+    tile_cols = (w + HISTORY_TILE_SIZE - 1) / HISTORY_TILE_SIZE;
+    first_gen = 0;
+    snapshots.clear();
+    changes.assign(depth > 0 ? (size_t)h * tile_cols : 0, 0);
+}
+
+void History::capture(uint gen, const Board& board) {
+    if (depth == 0)
+        return;
+    assert(snapshots.empty() || gen == first_gen + snapshots.size());
+    if (snapshots.empty())
+        first_gen = gen;
+
+    const Snapshot* previous = snapshots.empty() ? nullptr : &snapshots.back();
+    Snapshot snapshot(tile_rows * tile_cols);
+    for (uint tr = 0; tr < tile_rows; ++tr) {
+        for (uint tc = 0; tc < tile_cols; ++tc) {
+            uint t = tr * tile_cols + tc;
+            uint h = tile_height(tr);
+            uint w = tile_width(tc);
+            uint row = tr * HISTORY_TILE_SIZE;
+            uint col = tc * HISTORY_TILE_SIZE;
+
+            // Share the previous generation's tile if none of its rows changed
+            bool unchanged = previous != nullptr;
+            for (uint i = 0; i < h && unchanged; ++i) {
+                unchanged = !changes[(size_t)(row + i) * tile_cols + tc];
+            }
+            if (unchanged) {
+                snapshot[t] = (*previous)[t];
+                continue;
+            }
+
+            std::shared_ptr<Tile> tile = std::make_shared<Tile>(h * w);
+            for (uint i = 0; i < h; ++i) {
+                const uint* cells = board[row + i].data() + col;
+                std::copy(cells, cells + w, tile->data() + i * w);
+            }
+            snapshot[t] = tile;
+        }
+    }
+
+    snapshots.push_back(std::move(snapshot));
+    if (snapshots.size() > depth) {
+        snapshots.pop_front(); // Tiles no other generation shares are freed here
+        first_gen++;
+    }
+}
+
+unsigned char* History::change_flags() {
+    return changes.empty() ? nullptr : changes.data();
+}
+
+uint History::tile_columns() const {
+    return tile_cols;
+}
+
+bool History::contains(uint gen) const {
+    return gen >= first_gen && gen - first_gen < snapshots.size();
+}
+
+const History::Snapshot& History::at(uint gen) const {
+    assert(contains(gen));
+    return snapshots[gen - first_gen];
+}
+
+uint History::cell(const Snapshot& snapshot, uint i, uint j) const {
+    uint tc = j / HISTORY_TILE_SIZE;
+    const Tile& tile = *snapshot[(i / HISTORY_TILE_SIZE) * tile_cols + tc];
+    return tile[(i % HISTORY_TILE_SIZE) * tile_width(tc) + j % HISTORY_TILE_SIZE];
+}
+
+vector<string> History::board_lines(uint gen) const {
+    const Snapshot& snapshot = at(gen);
+    vector<string> lines(height);
+    for (uint i = 0; i < height; ++i) {
+        for (uint j = 0; j < width; ++j) {
+            if (j > 0)
+                lines[i] += DEF_MAT_DELIMITER;
+            lines[i] += std::to_string(cell(snapshot, i, j));
+        }
+    }
+    return lines;
+}
+
+size_t History::tiles_stored() const {
+    std::set<const Tile*> tiles;
+    for (auto &snapshot: snapshots) {
+        for (auto &tile: snapshot) {
+            tiles.insert(tile.get());
+        }
+    }
+    return tiles.size();
+}
+
+uint History::tile_height(uint tile_row) const {
+    return min<uint>(HISTORY_TILE_SIZE, height - tile_row * HISTORY_TILE_SIZE);
+}
+
+uint History::tile_width(uint tile_col) const {
+    return min<uint>(HISTORY_TILE_SIZE, width - tile_col * HISTORY_TILE_SIZE);
+}
@@ -0,0 +1,51 @@
+#ifndef __HISTORY_H
+#define __HISTORY_H
+#include "Headers.hpp"
+#include "Board.hpp"
+
+#define HISTORY_TILE_SIZE 64 // Tiles are HISTORY_TILE_SIZE x HISTORY_TILE_SIZE cells, smaller along the bottom and right edges
+
+/*--------------------------------------------------------------------------------
+								Generation History
+--------------------------------------------------------------------------------*/
+// Keeps the last `depth` generations of a board as copy-on-write tiles: a tile equal to
+// the same tile of the previous generation is shared by reference rather than copied,
+// so memory grows with the amount of change, not with board size x depth.
+// Which tiles changed is not found by comparing them: the phase 2 kernel flags, per row and
+// tile column, the cells it changed (see change_flags()), in parallel and as it writes them.
+class History {
+public:
+	typedef vector<uint> Tile; // Row major
+	typedef vector<std::shared_ptr<const Tile>> Snapshot; // Row major, tile_rows x tile_cols
+
+	History(uint depth); // depth == 0 keeps nothing
+	void reset(uint height, uint width); // Drops everything, for a board of the given size
+	// Generations must be captured in order, without gaps. Every tile but the ones change_flags()
+	// marks is shared with the previous generation, so the flags must cover all the changes since
+	void capture(uint gen, const Board& board);
+	// change_flags()[i * tile_columns() + tc] tells whether row i changed inside tile column tc
+	// since the last capture. nullptr if depth == 0
+	unsigned char* change_flags();
+	uint tile_columns() const;
+
+	bool contains(uint gen) const; // True if gen is retained
+	const Snapshot& at(uint gen) const; // O(1), gen must be retained
+	uint cell(const Snapshot& snapshot, uint i, uint j) const; // O(1), cell (i, j) of a snapshot
+	vector<string> board_lines(uint gen) const; // A retained generation in the input file format, see game_params::board_lines
+	size_t tiles_stored() const; // Distinct tiles held in memory, over all the retained generations
+
+private:
+	uint tile_height(uint tile_row) const;
+	uint tile_width(uint tile_col) const;
+
+	uint depth;
+	uint height;
+	uint width;
+	uint tile_rows;
+	uint tile_cols;
+	uint first_gen; // The generation of snapshots.front()
+	std::deque<Snapshot> snapshots;
+	vector<unsigned char> changes; // See change_flags()
+};
+
+#endif
@@ -4,17 +4,57 @@
 
 #ifndef CODE_SKELETON_JOB_H
 #define CODE_SKELETON_JOB_H
+// Per generation counters, accumulated by the threads while they compute their tiles
+struct gen_stats {
+    uint population[MAX_SPECIE + 1]; // population[s] = number of cells of specie s after the generation, [0] counts dead cells
+    uint births;                     // Dead cells that came alive in phase 1
+    uint deaths;                     // Live cells that died in phase 1
+
+    gen_stats(): population(), births(0), deaths(0){}
+};
+
+class Board;
+class Semaphore;
+
+// Everything a thread needs to work on a game, so a single pool of threads can serve several games
+struct job_context {
+    Board* game_matrix_curr;
+    Board* game_matrix_next;
+    vector<double>* tile_hist;
+    pthread_mutex_t* mutex;     // Guards tile_hist and the gen_stats of the game
+    Semaphore* completed_jobs;  // Up'ed once the job is done
+    // Only the cells in rows [counted_row_begin, counted_row_end) x columns [counted_col_begin, counted_col_end)
+    // are counted into gen_stats: the requested region, without the rest of the light cone (see Game::set_light_cone)
+    uint counted_row_begin;
+    uint counted_row_end;
+    uint counted_col_begin;
+    uint counted_col_end;
+    // Unless nullptr, phase 2 sets changes[i * change_columns + c] to whether it changed a cell of row i
+    // in columns [c * change_width, (c+1) * change_width), see History::change_flags
+    unsigned char* changes;
+    uint change_columns;
+    uint change_width;
+};
+
+enum job_kind {
+    PREFAULT,   // First touch of the range's rows, before the board is loaded
+    PHASE_ONE,
+    PHASE_TWO,
+    EXIT        // Not a tile: the thread that pops it exits
+};
+
 class Job{
 public:
     tuple<int, int> thread_range_coverage;
     uint matrix_height;
     uint matrix_width;
-    bool phase;
-    bool is_last_gen_phase_two;
+    job_kind kind;
+    job_context* context;
+    gen_stats* stats; // The generation's counters, the thread adds its tile's share into them
 
-    Job(tuple<int, int> range, uint h, uint w, bool phase, bool end):
+    Job(tuple<int, int> range, uint h, uint w, job_kind kind, job_context* context, gen_stats* stats):
             thread_range_coverage(range), matrix_height(h),matrix_width(w),
-            phase(phase), is_last_gen_phase_two(end){}
+            kind(kind), context(context), stats(stats){}
 
     ~Job() = default;
 };
@@ -3,7 +3,8 @@
 #include <cassert>
 #include "Headers.hpp"
 #include "Semaphore.hpp"
-// Single Producer - Multiple Consumer queue
+// Multiple Producer - Multiple Consumer queue (push and pop both take the same lock).
+// A Game is its only producer, but on a shared pool every Server driver thread pushes to it.
 template <typename T>class PCQueue
 {
 
@@ -15,7 +16,7 @@ public:
 
 	// Allows for producer to enter with *minimal delay* and push items to back of the queue.
 	// Hint for *minimal delay* - Allow the consumers to delay the producer as little as possible.  
-	// Assumes single producer 
+	// Safe with several producers, see the note above
 	void push(const T& item); 
 
     PCQueue();
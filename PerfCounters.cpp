@@ -0,0 +1,45 @@
+#include "PerfCounters.hpp"
+
+PerfCounters::PerfCounters(): page_faults_fd(-1), tlb_misses_fd(-1), m_page_faults(-1), m_tlb_misses(-1){}
+
+PerfCounters::~PerfCounters() {
+    if (page_faults_fd >= 0)
+        close(page_faults_fd);
+    if (tlb_misses_fd >= 0)
+        close(tlb_misses_fd);
+}
+
+void PerfCounters::start() {
+    page_faults_fd = open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+    tlb_misses_fd = open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                                                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+
+void PerfCounters::stop() {
+    m_page_faults = read_counter(page_faults_fd);
+    m_tlb_misses = read_counter(tlb_misses_fd);
+}
+
+int PerfCounters::open_counter(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.inherit = 1; // Count the worker threads too
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    return fd;
+}
+
+long long PerfCounters::read_counter(int fd) {
+    if (fd < 0)
+        return -1;
+    long long count = 0;
+    if (read(fd, &count, sizeof(count)) != sizeof(count))
+        return -1;
+    return count;
+}
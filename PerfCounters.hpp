@@ -0,0 +1,32 @@
+#ifndef __PERF_COUNTERS_H
+#define __PERF_COUNTERS_H
+#include "Headers.hpp"
+
+/*--------------------------------------------------------------------------------
+							Hardware & Kernel Counters
+--------------------------------------------------------------------------------*/
+// Counts page faults and data TLB misses through perf_event_open.
+// Counters are inherited, so start() must be called before the threads are created,
+// and read after they were joined - their counts are folded into ours when they exit.
+// A counter the kernel refuses to open (no permission, no PMU in a VM...) reads as -1.
+class PerfCounters {
+public:
+	PerfCounters();
+	~PerfCounters();
+
+	void start();
+	void stop();
+	long long page_faults() const { return m_page_faults; }
+	long long tlb_misses() const { return m_tlb_misses; }
+
+private:
+	static int open_counter(uint32_t type, uint64_t config);
+	static long long read_counter(int fd);
+
+	int page_faults_fd;
+	int tlb_misses_fd;
+	long long m_page_faults;
+	long long m_tlb_misses;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "Recolor.hpp"
+
+const Recolor& Recolor::instance() {
+    static const Recolor recolor; // Thread safe initialization since C++11
+    return recolor;
+}
+
+Recolor::Recolor() {
+    for (uint alive = 0; alive <= MAX_NEIGHBORHOOD; ++alive) {
+        for (uint sum = 0; sum <= MAX_NEIGHBORHOOD * MAX_SPECIE; ++sum) {
+            // floor(sum/alive + 1/2) == round(sum/alive) for non negative values, half-way included
+            lut[alive][sum] = alive == 0 ? 0 : (2 * sum + alive) / (2 * alive);
+        }
+    }
+}
+
+void Recolor::recolor_row(const Board& src, Board::Row dst, int row,
+                          vector<uint>& col_sum, vector<uint>& col_cnt, uint* population,
+                          uint count_begin, uint count_end, unsigned char* changed, uint changed_width) const {
+    int height = (int)src.size();
+    int width = (int)src[row].size();
+    int low_bound = row-1 >= 0 ? row-1: 0;
+    int high_bound = row+1 < height ? row+1 : height-1;
+
+    /* Column sums are padded with a zero column on each side, so the
+     * horizontal window below needs no bounds checks at the edges.
+     */
+    col_sum.assign(width + 2, 0);
+    col_cnt.assign(width + 2, 0);
+    for (int k = low_bound; k <= high_bound; ++k) {
+        const uint* line = src[k].data();
+        for (int j = 0; j < width; ++j) {
+            col_sum[j+1] += line[j];          // Dead cells add 0
+            col_cnt[j+1] += (line[j] != 0);
+        }
+    }
+
+    const uint* self = src[row].data();
+    uint* out = dst.data();
+    int chunk = changed ? (int)changed_width : width; // Columns whose changes are summed into one flag
+    for (int begin = 0, c = 0; begin < width; begin += chunk, ++c) {
+        int end = min(begin + chunk, width);
+        uint diff = 0;
+        for (int j = begin; j < end; ++j) {
+            uint sum = col_sum[j] + col_sum[j+1] + col_sum[j+2];
+            uint alive = col_cnt[j] + col_cnt[j+1] + col_cnt[j+2];
+            //If a cell is dead in phase 2 he will remain dead
+            uint color = lut[alive][sum] & -(uint)(self[j] != 0);
+            diff |= out[j] ^ color;
+            out[j] = color;
+        }
+        if (changed)
+            changed[c] = diff != 0;
+    }
+    for (uint j = count_begin; j < count_end; ++j) {
+        population[out[j]]++;
+    }
+}
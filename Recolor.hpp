@@ -0,0 +1,35 @@
+#ifndef __RECOLOR_H
+#define __RECOLOR_H
+#include "Headers.hpp"
+#include "Board.hpp"
+
+#define MAX_NEIGHBORHOOD 9 // A 3x3 neighborhood, the cell itself included
+
+/*--------------------------------------------------------------------------------
+						Integer-only phase 2 recoloring
+--------------------------------------------------------------------------------*/
+// Phase 2 sets every live cell to round(sum / alive) over its 3x3 neighborhood.
+// Since sum <= 63 and alive <= 9, the whole result space fits in a small table,
+// so a row is recolored with integer adds and a single lookup per cell.
+class Recolor {
+public:
+	static const Recolor& instance(); // Built once, shared (read only) by all the threads
+
+	// Returns round(sum / alive) with round()'s half-way-away-from-zero semantics, 0 if alive == 0
+	unsigned char at(uint alive, uint sum) const { return lut[alive][sum]; }
+
+	// Recolors row `row` of src into dst. col_sum and col_cnt are scratch buffers owned
+	// by the caller, so no allocation happens on the hot path once they are sized.
+	// The resulting species of columns [count_begin, count_end) are counted into population[0..MAX_SPECIE].
+	// Unless changed is nullptr, changed[c] is set to whether any cell of columns
+	// [c * changed_width, (c+1) * changed_width) differs from what dst held before.
+	void recolor_row(const Board& src, Board::Row dst, int row,
+					 vector<uint>& col_sum, vector<uint>& col_cnt, uint* population,
+					 uint count_begin, uint count_end, unsigned char* changed, uint changed_width) const;
+
+private:
+	Recolor();
+	unsigned char lut[MAX_NEIGHBORHOOD + 1][MAX_NEIGHBORHOOD * MAX_SPECIE + 1];
+};
+
+#endif
@@ -0,0 +1,311 @@
+#include "Server.hpp"
+#include "utils.hpp"
+
+#define SERVER_READ_SIZE 65536
+
+/*--------------------------------------------------------------------------------
+
+--------------------------------------------------------------------------------*/
+Server::Server(server_params p): params(p), listen_fd(-1), stopping(false), running_sessions(0), next_queue(0) {
+    user_error("Failed to create the wake up pipe", (pipe(wake_pipe) == 0));
+    pthread_mutex_init(&cancel_mutex, nullptr);
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    user_error(string("Socket path too long: ") + params.socket_path,
+               (params.socket_path.size() < sizeof(addr.sun_path)));
+    strncpy(addr.sun_path, params.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    user_error("Failed to create the server socket", (listen_fd >= 0));
+    unlink(params.socket_path.c_str()); // A leftover from a previous run would fail bind()
+    bool listening = bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) == 0 &&
+                     listen(listen_fd, SOMAXCONN) == 0;
+    user_error(string("Failed to listen on ") + params.socket_path, listening);
+
+    for (uint i = 0; i < params.n_thread; i++) {
+        jobs_queues.emplace_back();
+        GameThread* gh = new GameThread(i, &jobs_queues.back());
+        m_threadpool.push_back(gh);
+        gh->start();
+    }
+}
+
+Server::~Server() {
+    for (auto &queue: jobs_queues) {
+        queue.push(new Job(tuple<int, int>{0, 0}, 0, 0, EXIT, nullptr, nullptr));
+    }
+    for (auto &thread: m_threadpool) {
+        thread->join();
+        delete thread;
+    }
+    close(listen_fd);
+    unlink(params.socket_path.c_str());
+    close(wake_pipe[0]);
+    close(wake_pipe[1]);
+    pthread_mutex_destroy(&cancel_mutex);
+}
+
+void Server::stop() {
+    Session* none = nullptr;
+    ssize_t ignored = write(wake_pipe[1], &none, sizeof(none));
+    (void)ignored;
+}
+
+void Server::serve() {
+    while (!stopping || running_sessions > 0) {
+        int timeout = close_idle_sessions();
+        vector<struct pollfd> fds;
+        fds.push_back(pollfd{wake_pipe[0], POLLIN, 0});
+        // Past SERVER_MAX_CONNECTIONS new clients are left in the backlog, so partial requests take bounded memory
+        bool accepting = !stopping && sessions.size() < SERVER_MAX_CONNECTIONS;
+        if (accepting)
+            fds.push_back(pollfd{listen_fd, POLLIN, 0});
+        vector<Session*> polled; // polled[i] owns fds[first_session + i]
+        size_t first_session = fds.size();
+        for (auto &session: sessions) {
+            if (!session->hung_up) {
+                // After a half-close only POLLHUP (always reported) matters: the client closed for good
+                fds.push_back(pollfd{session->fd, (short)(session->read_done ? 0 : POLLIN), 0});
+                polled.push_back(session);
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), timeout) < 0)
+            continue; // EINTR - the signal handler already called stop()
+
+        for (size_t i = 0; i < polled.size(); ++i) {
+            if (fds[first_session + i].revents)
+                read_session(polled[i], fds[first_session + i].revents);
+        }
+        if (accepting && fds[1].revents & POLLIN)
+            accept_sessions();
+        if (fds[0].revents & POLLIN) {
+            Session* finished;
+            if (read(wake_pipe[0], &finished, sizeof(finished)) == sizeof(finished)) {
+                if (finished)
+                    finish_session(finished);
+                else if (!stopping) {
+                    stopping = true;
+                    for (auto &session: sessions) {
+                        if (session->running)
+                            cancel_session(session);
+                    }
+                }
+            }
+        }
+        start_pending();
+    }
+
+    while (!sessions.empty())
+        close_session(sessions.back());
+}
+
+/*--------------------------------------------------------------------------------
+							 Auxiliary Implementation
+--------------------------------------------------------------------------------*/
+void Server::accept_sessions() {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0)
+        return;
+    sessions.push_back(new Session{this, fd, string(), string::npos, nullptr, false, false, false, false, pthread_t(),
+                                   std::chrono::steady_clock::now()});
+}
+
+int Server::close_idle_sessions() {
+    auto now = std::chrono::steady_clock::now();
+    auto limit = std::chrono::milliseconds(SERVER_IDLE_TIMEOUT_MS);
+    int timeout = -1;
+    vector<Session*> idle;
+    for (auto &session: sessions) {
+        if (session->request_end != string::npos)
+            continue; // Complete: waiting for a slot or for the game, however long it takes
+        if (now - session->last_read >= limit) {
+            idle.push_back(session);
+            continue;
+        }
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(session->last_read + limit - now).count() + 1;
+        timeout = timeout < 0 ? (int)left : min(timeout, (int)left);
+    }
+    for (auto &session: idle) {
+        reply(session->fd, "ERR idle for " + std::to_string(SERVER_IDLE_TIMEOUT_MS) + " ms before the request was complete\n");
+        close_session(session);
+    }
+    return timeout;
+}
+
+void Server::read_session(Session* session, short revents) {
+    char buffer[SERVER_READ_SIZE];
+    bool complete = session->request_end != string::npos;
+    /* A Unix socket reports POLLHUP only once the client closed both directions.
+     * End of file without it is a half-close: harmless once the request is complete.
+     */
+    bool closed = revents & (POLLHUP | POLLERR);
+    ssize_t n = closed ? -1 : read(session->fd, buffer, sizeof(buffer));
+    if (n == 0 && complete) {
+        session->read_done = true;
+        return;
+    }
+    if (n <= 0) {
+        session->hung_up = true;
+        if (session->running)
+            cancel_session(session); // The driver wakes us up once the game returns
+        else
+            close_session(session);
+        return;
+    }
+    if (complete)
+        return; // Anything past the end of the request is ignored
+
+    session->last_read = std::chrono::steady_clock::now();
+    // Only the bytes just read can complete the empty line, so the request is scanned once overall
+    size_t scanned = session->request.size();
+    session->request.append(buffer, n);
+    session->request_end = session->request.find("\n\n", scanned > 0 ? scanned - 1 : 0);
+    if (session->request_end != string::npos)
+        pending.push_back(session); // Parsed by its driver, off this thread
+    else if (session->request.size() > SERVER_MAX_REQUEST_BYTES) {
+        reply(session->fd, "ERR request larger than " + std::to_string(SERVER_MAX_REQUEST_BYTES) + " bytes\n");
+        close_session(session);
+    }
+}
+
+string Server::parse_request(Session* session, game_params& g) const {
+    session->request.resize(session->request_end); // Drops the empty line and anything after it
+    vector<string> lines = utils::split(session->request, '\n');
+    string().swap(session->request);
+    for (auto &line: lines) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+    }
+
+    vector<string> header = lines.empty() ? vector<string>() : utils::split(lines[0], DEF_MAT_DELIMITER);
+    uint n_gen = 0;
+    uint n_tiles = params.n_thread;
+    bool header_ok = (header.size() == 1 || header.size() == 2) && utils::parse_uint(header[0], n_gen) &&
+                     (header.size() == 1 || utils::parse_uint(header[1], n_tiles));
+    if (session->request_end > SERVER_MAX_REQUEST_BYTES)
+        return "request larger than " + std::to_string(SERVER_MAX_REQUEST_BYTES) + " bytes";
+    if (!header_ok || n_gen == 0 || n_tiles == 0)
+        return "invalid header (Required: <number_of_generations> [number_of_tiles])";
+    if (n_gen > SERVER_MAX_GENERATIONS)
+        return "too many generations (at most " + std::to_string(SERVER_MAX_GENERATIONS) + ")";
+    if (lines.size() < 2)
+        return "empty board";
+
+    // The board is validated here, since Game treats a malformed input file as fatal
+    size_t width = utils::split(lines[1], DEF_MAT_DELIMITER).size();
+    for (uint i = 1; i < lines.size(); ++i) {
+        vector<string> cells = utils::split(lines[i], DEF_MAT_DELIMITER);
+        if (cells.size() != width)
+            return "rows of different widths";
+        for (auto &cell: cells) {
+            if (cell.empty() || cell.size() > 1 || cell[0] < '0' || cell[0] > '0' + MAX_SPECIE)
+                return string("invalid cell: ") + cell;
+        }
+    }
+
+    g.n_gen = n_gen;
+    g.n_thread = min(n_tiles, params.n_thread); // Never more tiles per phase than there are threads, see Server
+    g.interactive_on = false;
+    g.print_on = false;
+    g.roi = region{0, 0, 0, 0};
+    g.history_depth = 0;
+    g.board_lines.assign(lines.begin() + 1, lines.end());
+    return string();
+}
+
+vector<PCQueue<Job*>*> Server::take_queues(uint n_tiles) {
+    uint first = next_queue.fetch_add(n_tiles) % jobs_queues.size();
+    vector<PCQueue<Job*>*> queues; // The pool's queues, starting at first
+    for (uint i = 0; i < jobs_queues.size(); ++i) {
+        queues.push_back(&jobs_queues[(first + i) % jobs_queues.size()]);
+    }
+    return queues;
+}
+
+void Server::start_pending() {
+    while (!stopping && running_sessions < params.max_sessions && !pending.empty()) {
+        Session* session = pending.front();
+        pending.pop_front();
+        session->running = true;
+        running_sessions++;
+        pthread_create(&session->driver, nullptr, drive, session);
+    }
+}
+
+void Server::cancel_session(Session* session) {
+    pthread_mutex_lock(&cancel_mutex);
+    session->cancelled = true;
+    if (session->game)
+        session->game->cancel();
+    pthread_mutex_unlock(&cancel_mutex);
+}
+
+void* Server::drive(void* arg) {
+    Session* session = (Session*)arg;
+    Server* server = session->server;
+    string error;
+    auto start = std::chrono::system_clock::now();
+    try {
+        game_params g;
+        error = server->parse_request(session, g);
+        if (error.empty()) {
+            Game* game = new Game(g, server->take_queues(g.n_thread));
+            pthread_mutex_lock(&server->cancel_mutex);
+            session->game = game;
+            if (session->cancelled)
+                game->cancel(); // The client left, or the server is stopping, while the request was parsed
+            pthread_mutex_unlock(&server->cancel_mutex);
+            start = std::chrono::system_clock::now();
+            game->run();
+        }
+    } catch (const std::exception& e) {
+        error = e.what(); // e.g. std::bad_alloc for a board too big for the memory left - only this session fails
+    }
+    auto end = std::chrono::system_clock::now();
+
+    if (!error.empty()) {
+        reply(session->fd, "ERR " + error + "\n");
+    } else if (!session->game->cancelled()) {
+        std::ostringstream out;
+        out << "OK " << session->game->gen_hist().size() << " "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "\n";
+        for (auto &row: session->game->region_board()) {
+            for (uint j = 0; j < row.size(); ++j) {
+                out << (j ? " " : "") << row[j];
+            }
+            out << "\n";
+        }
+        reply(session->fd, out.str());
+    }
+    ssize_t ignored = write(server->wake_pipe[1], &session, sizeof(session));
+    (void)ignored;
+    return NULL;
+}
+
+void Server::finish_session(Session* session) {
+    pthread_join(session->driver, nullptr);
+    session->running = false;
+    running_sessions--;
+    close_session(session);
+}
+
+void Server::close_session(Session* session) {
+    pending.erase(std::remove(pending.begin(), pending.end(), session), pending.end());
+    sessions.erase(std::remove(sessions.begin(), sessions.end(), session), sessions.end());
+    close(session->fd);
+    delete session->game;
+    delete session;
+}
+
+void Server::reply(int fd, const string& message) {
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t n = send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            return; // The client is gone
+        sent += n;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef __SERVER_H
+#define __SERVER_H
+#include "Headers.hpp"
+#include "Game.hpp"
+
+/*--------------------------------------------------------------------------------
+								  Wire Protocol
+--------------------------------------------------------------------------------*/
+// One request per connection, over a Unix stream socket.
+// Request: "<number_of_generations> [number_of_tiles]\n", then the board in the input file
+//          format (one row per line, cells separated by DEF_MAT_DELIMITER), then an empty line.
+//          Closing the connection before the reply arrives cancels the simulation, while shutting
+//          down only its write side once the request was sent (as nc -U does) does not.
+// Reply:   "OK <generations> <usec>\n" followed by the final board in the same format,
+//          or "ERR <message>\n". The server closes the connection after the reply.
+
+#define SERVER_MAX_GENERATIONS 1000000 // Requests asking for more generations are refused
+#define SERVER_MAX_REQUEST_BYTES (16 * 1024 * 1024) // Requests growing past this size are refused
+#define SERVER_MAX_CONNECTIONS 64 // Open connections at most, later ones wait in the listen backlog
+#define SERVER_IDLE_TIMEOUT_MS 10000 // Connections sending nothing for this long before their request is complete are closed
+
+/*--------------------------------------------------------------------------------
+								  Auxiliary Structures
+--------------------------------------------------------------------------------*/
+struct server_params {
+	string socket_path;
+	uint n_thread;     // Size of the compute pool, shared by all the simulations
+	uint max_sessions; // Simulations running at once, complete requests beyond it wait in arrival order
+};
+
+/*--------------------------------------------------------------------------------
+									Class Declaration
+--------------------------------------------------------------------------------*/
+// A single threaded poll() loop accepts connections and reads requests. Every complete request
+// gets a driver thread, which parses it and runs it as a Game on the shared pool. Each pool thread pops its own FIFO queue, and tile i
+// of a Game always goes to the same queue, so a thread keeps working on the rows it faulted in.
+// Each Game pushes at most one tile per queue per phase and waits for them before pushing more,
+// so every queue serves the running simulations round robin, one phase at a time. Games start
+// at rotating queues, so the ones with fewer tiles than threads are spread over the pool.
+class Server {
+public:
+	Server(server_params);
+	~Server();
+	void serve(); // Runs the event loop until stop() is called
+	void stop();  // Async signal safe
+
+private:
+	struct Session {
+		Server* server;
+		int fd;
+		string request;     // Bytes received so far
+		size_t request_end; // Where the empty line ending the request starts, string::npos until it arrived
+		Game* game;         // Set by the driver once the request was parsed, guarded by cancel_mutex
+		bool cancelled;     // The game must stop (or not start), guarded by cancel_mutex
+		bool running;       // A driver thread was started for the session
+		bool hung_up;       // The client closed the connection
+		bool read_done;     // The client half-closed after a complete request (shutdown(SHUT_WR)), it still waits for the reply
+		pthread_t driver;
+		std::chrono::steady_clock::time_point last_read; // When the client last sent something (or connected)
+	};
+
+	void accept_sessions();
+	void read_session(Session* session, short revents);
+	int close_idle_sessions(); // Returns the poll() timeout until the next session may go idle, -1 if none can
+	string parse_request(Session* session, game_params& g) const; // Called by the driver, returns an error message or ""
+	vector<PCQueue<Job*>*> take_queues(uint n_tiles); // Thread safe: the pool's queues a new Game pushes its tiles to
+	void start_pending();
+	void cancel_session(Session* session);
+	void finish_session(Session* session);
+	void close_session(Session* session);
+	static void* drive(void* session); // Driver thread: parses the request, runs the game and writes the reply
+	static void reply(int fd, const string& message);
+
+	server_params params;
+	int listen_fd;
+	int wake_pipe[2]; // Drivers write their finished Session*, stop() writes nullptr
+	bool stopping;
+	uint running_sessions;
+
+	vector<Session*> sessions;
+	std::deque<Session*> pending; // Complete requests waiting for a free session slot
+	pthread_mutex_t cancel_mutex; // Orders a driver publishing its Game against the loop cancelling it
+	std::deque<PCQueue<Job*>> jobs_queues; // jobs_queues[i] feeds m_threadpool[i]
+	std::atomic<uint> next_queue; // The queue the next Game's first tile goes to
+	vector<GameThread*> m_threadpool;
+};
+
+#endif
@@ -3,20 +3,15 @@
 #include "Headers.hpp"
 #include "PCQueue.hpp"
 #include "Job.h"
+#include "Board.hpp"
+#include "Recolor.hpp"
 
 class Thread
 {
 public:
-	Thread(uint thread_id, PCQueue<Job*>* jobs_q, vector<double>* hist,
-	        pthread_mutex_t* m, vector<vector<uint>>* curr,
-	        vector<vector<uint>>* next, Semaphore* completed){
+	Thread(uint thread_id, PCQueue<Job*>* jobs_q){
 	    m_thread_id = thread_id;
 	    jobs_queue = jobs_q;
-	    completed_jobs = completed;
-	    m_tile_hist = hist;
-	    mutex = m;
-	    game_matrix_curr = curr;
-	    game_matrix_next = next;
 	}
 
 	virtual ~Thread() {} // Does nothing 
@@ -42,13 +37,7 @@ protected:
 	/** Implement this method in your subclass with the code you want your thread to run. */
 	virtual void thread_workload() = 0;
 	uint m_thread_id; // A number from 0 -> Number of threads initialized, providing a simple numbering for you to use
-    PCQueue<Job*>* jobs_queue;
-    //int* completed_jobs;
-    vector<double>* m_tile_hist;
-    pthread_mutex_t* mutex;
-    vector<vector<uint>>* game_matrix_curr;
-    vector<vector<uint>>* game_matrix_next;
-    Semaphore* completed_jobs;
+    PCQueue<Job*>* jobs_queue; // The boards and the completion semaphore come with each job, see job_context
 
 private:
 	static void * entry_func(void * thread) { ((Thread *)thread)->thread_workload(); return NULL; }
@@ -58,22 +47,38 @@ private:
 
 class GameThread: public Thread{
 public:
-    GameThread(uint thread_id, PCQueue<Job*>* jobs_queue, vector<double>* hist,
-				pthread_mutex_t* m, vector<vector<uint>>* curr,
-				vector<vector<uint>>* next, Semaphore* completed):
-               Thread(thread_id, jobs_queue, hist, m, curr, next, completed){}
+    GameThread(uint thread_id, PCQueue<Job*>* jobs_queue):
+               Thread(thread_id, jobs_queue){}
     ~GameThread() = default;
 
     void thread_workload() {
         while (true) {
             Job* job = jobs_queue->pop();
+            if (job->kind == EXIT) {
+                delete job;
+                return;
+            }
+            Board* game_matrix_curr = job->context->game_matrix_curr;
+            Board* game_matrix_next = job->context->game_matrix_next;
+            Semaphore* completed_jobs = job->context->completed_jobs;
+            const job_context& counted = *job->context; // Bounds of the cells counted into gen_stats
             int range_start = get<0>(job->thread_range_coverage);
             int range_end = get<1>(job->thread_range_coverage);
+
+            if (job->kind == PREFAULT) {
+                game_matrix_curr->prefault(range_start, range_end);
+                game_matrix_next->prefault(range_start, range_end);
+                delete job;
+                completed_jobs->up();
+                continue;
+            }
             
 			auto start = std::chrono::system_clock::now();
+			gen_stats tile_stats; // Tile counters, kept local until the reduction below
 			
-            if (!job->phase) {//Starting phase 1
+            if (job->kind == PHASE_ONE) {//Starting phase 1
                 for (int i = range_start; i < range_end; ++i) {
+                    bool row_counted = (uint)i >= counted.counted_row_begin && (uint)i < counted.counted_row_end;
 					//Bounds for neighbors searching
 					int low_bound = i-1 >= 0 ? i-1: 0;
                     int high_bound = i+1 < (int)game_matrix_curr->size() ? i+1 : (int)game_matrix_curr->size()-1;
@@ -83,6 +88,8 @@ public:
 						int left_bound = j-1 >= 0 ? j-1: 0;
                         int right_bound = (int)(*game_matrix_curr)[i].size()-1 < j+1 ? (int)(*game_matrix_curr)[i].size()-1 : j+1;
 
+                        bool cell_counted = row_counted && (uint)j >= counted.counted_col_begin &&
+                                            (uint)j < counted.counted_col_end;
                         int alive_neighbors = 0;
                         vector<int> specie_histogram(8, 0);// counting the appearances of each specie in the neighborhood
 
@@ -109,8 +116,10 @@ public:
                                 }
                                 (*game_matrix_next)[i][j] = dominant;
                             }
+                            tile_stats.births += cell_counted;
                         } else if ((*game_matrix_curr)[i][j] > 0 && alive_neighbors != 2 && alive_neighbors != 3) {
                             (*game_matrix_next)[i][j] = 0;
+                            tile_stats.deaths += cell_counted;
                         } else {
                             (*game_matrix_next)[i][j] = (*game_matrix_curr)[i][j];
                         }
@@ -118,50 +127,37 @@ public:
                 }
             }
             else {//Starting phase 2
+                /*-----------------------------------------------
+                 * Searching for dominant specie in neighborhood,
+                 * row by row with integer arithmetic only
+                 ------------------------------------------------*/
+                const Recolor& recolor = Recolor::instance();
                 for (int i = range_start; i < range_end; ++i) {
-					//Bounds for neighbors searching
-                    int low_bound = i-1 >= 0 ? i-1: 0;
-                    int high_bound = i+1 < (int)game_matrix_curr->size() ? i+1 : (int)game_matrix_curr->size()-1;
-
-                    for (int j = 0; j < (int) (*game_matrix_next)[i].size(); ++j) {
-						//If a cell is dead in phase 2 he will remain dead
-                        if ((*game_matrix_next)[i][j] == 0) {
-                            (*game_matrix_curr)[i][j] = 0;
-                            continue;
-                        }
-						//Bounds for neighbors searching
-                        int left_bound = j-1 >= 0 ? j-1: 0;
-                        int right_bound = (int)(*game_matrix_curr)[i].size()-1 < j+1 ? (int)(*game_matrix_curr)[i].size()-1 : j+1;
-
-                        double alive_neighbors = 0;
-                        double sum = 0;
-                        /*-----------------------------------------------
-                         * Searching for dominant specie in neighborhood
-                         ------------------------------------------------*/
-                        for (int k = low_bound; k <= high_bound; ++k) {
-                            for (int l = left_bound; l <= right_bound; ++l) {
-                                if ((*game_matrix_next)[k][l] > 0) {
-                                    alive_neighbors++;
-                                    sum += (*game_matrix_next)[k][l];
-                                }
-                            }
-                        }
-                        (*game_matrix_curr)[i][j] = round(sum / alive_neighbors);
-                    }
+                    bool row_counted = (uint)i >= counted.counted_row_begin && (uint)i < counted.counted_row_end;
+                    recolor.recolor_row(*game_matrix_next, (*game_matrix_curr)[i], i, col_sum, col_cnt,
+                                        tile_stats.population,
+                                        row_counted ? counted.counted_col_begin : 0,
+                                        row_counted ? counted.counted_col_end : 0,
+                                        counted.changes ? counted.changes + (size_t)i * counted.change_columns : nullptr,
+                                        counted.change_width);
                 }
             }
 			auto end = std::chrono::system_clock::now();
-            pthread_mutex_lock(mutex);
-            m_tile_hist->push_back((double) std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
-            pthread_mutex_unlock(mutex);
-			bool exit = job->is_last_gen_phase_two;
+            pthread_mutex_lock(job->context->mutex);
+            job->context->tile_hist->push_back((double) std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+            for (int s = 0; s <= MAX_SPECIE; ++s) {
+                job->stats->population[s] += tile_stats.population[s];
+            }
+            job->stats->births += tile_stats.births;
+            job->stats->deaths += tile_stats.deaths;
+            pthread_mutex_unlock(job->context->mutex);
 			delete job;
 			completed_jobs->up();
-		
-            if(exit) {
-                return;
-            }
         }
     }
+
+private:
+    vector<uint> col_sum; // Phase 2 scratch buffers, reused across jobs
+    vector<uint> col_cnt;
 };
 #endif
@@ -0,0 +1,136 @@
+#include "Game.hpp"
+
+#define TEST_THREADS 3
+#define TEST_DEPTH 16 // Generations kept by the sharing checks
+#define TEST_GENERATIONS 12 // Length of the runs seek and resume are compared against
+
+static bool check_sharing();
+static bool check_seek(region roi);
+static bool check_resume(region roi);
+static game_params make_params(const vector<string>& lines, uint n_gen, uint history_depth, region roi);
+static vector<vector<uint>> run(const game_params& params);
+static vector<string> blocks_board(uint size, bool blinker);
+static vector<string> random_board(uint height, uint width);
+
+/*--------------------------------------------------------------------------------
+										Main
+--------------------------------------------------------------------------------*/
+// Checks that History shares unchanged tiles, and that seek and resume_params agree with plain runs
+int main() {
+
+    region whole{0, 0, 0, 0};
+    region window{40, 30, 20, 25};
+    bool sharing_ok = check_sharing();
+    bool seek_ok = check_seek(whole) && check_seek(window);
+    bool resume_ok = check_resume(whole) && check_resume(window);
+    cout << "History sharing: " << (sharing_ok ? "OK" : "FAILED") << endl;
+    cout << "History seek: " << (seek_ok ? "OK" : "FAILED") << endl;
+    cout << "History resume: " << (resume_ok ? "OK" : "FAILED") << endl;
+    return sharing_ok && seek_ok && resume_ok ? 0 : 1;
+}
+/*--------------------------------------------------------------------------------
+							 Auxiliary Implementation
+--------------------------------------------------------------------------------*/
+// A still life keeps a single snapshot's worth of tiles however many generations are kept,
+// and a blinker in one tile adds a single tile per generation
+static bool check_sharing() {
+    uint size = 200;
+    uint tiles_per_snapshot = ((size + HISTORY_TILE_SIZE - 1) / HISTORY_TILE_SIZE) *
+                              ((size + HISTORY_TILE_SIZE - 1) / HISTORY_TILE_SIZE);
+    bool ok = true;
+    for (int blinker = 0; blinker <= 1; ++blinker) {
+        Game g(make_params(blocks_board(size, blinker), 2 * TEST_DEPTH, TEST_DEPTH, region{0, 0, 0, 0}));
+        g.run();
+        size_t expected = tiles_per_snapshot + (blinker ? TEST_DEPTH - 1 : 0);
+        if (g.history().tiles_stored() != expected) {
+            cerr << (blinker ? "Blinker" : "Still life") << ": " << g.history().tiles_stored()
+                 << " tiles stored, expected " << expected << endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// seek(k) of a longer run shows the same window as a run of k generations
+static bool check_seek(region roi) {
+    vector<string> board = random_board(150, 130);
+    Game g(make_params(board, TEST_GENERATIONS, TEST_GENERATIONS + 1, roi));
+    g.run();
+    for (uint k = 1; k <= TEST_GENERATIONS; k += 5) {
+        if (!g.seek(k) || g.region_board() != run(make_params(board, k, 0, roi))) {
+            cerr << "seek(" << k << ") differs from a run of " << k << " generations" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// A game resumed from generation k ends with the same window as the uninterrupted run
+static bool check_resume(region roi) {
+    vector<string> board = random_board(150, 130);
+    Game g(make_params(board, TEST_GENERATIONS, TEST_GENERATIONS + 1, roi));
+    g.run();
+    for (uint k = 0; k < TEST_GENERATIONS; k += 5) {
+        if (run(g.resume_params(k, TEST_GENERATIONS - k)) != g.region_board()) {
+            cerr << "Resuming from generation " << k << " differs from the uninterrupted run" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static game_params make_params(const vector<string>& lines, uint n_gen, uint history_depth, region roi) {
+    game_params g;
+    g.n_gen = n_gen;
+    g.n_thread = TEST_THREADS;
+    g.interactive_on = false;
+    g.print_on = false;
+    g.roi = roi;
+    g.board_lines = lines;
+    g.history_depth = history_depth;
+    return g;
+}
+
+static vector<vector<uint>> run(const game_params& params) {
+    Game g(params);
+    g.run();
+    return g.region_board();
+}
+
+// 2x2 blocks (a still life, whatever their species) 3 cells apart, outside the top left tile.
+// The optional blinker sits alone in the top left tile
+static vector<string> blocks_board(uint size, bool blinker) {
+    vector<vector<uint>> cells(size, vector<uint>(size, 0));
+    for (uint i = HISTORY_TILE_SIZE; i + 1 < size; i += 5) {
+        for (uint j = HISTORY_TILE_SIZE; j + 1 < size; j += 5) {
+            uint specie = 1 + (i + j) % MAX_SPECIE;
+            cells[i][j] = cells[i][j+1] = cells[i+1][j] = cells[i+1][j+1] = specie;
+        }
+    }
+    if (blinker)
+        cells[10][10] = cells[10][11] = cells[10][12] = 1;
+
+    vector<string> lines;
+    for (auto &row: cells) {
+        string line;
+        for (uint j = 0; j < row.size(); ++j) {
+            line += (j ? string(1, DEF_MAT_DELIMITER) : string()) + std::to_string(row[j]);
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+static vector<string> random_board(uint height, uint width) {
+    srand(height * width);
+    vector<string> lines;
+    for (uint i = 0; i < height; ++i) {
+        string line;
+        for (uint j = 0; j < width; ++j) {
+            uint cell = rand() % 2 ? 0 : 1 + rand() % MAX_SPECIE;
+            line += (j ? string(1, DEF_MAT_DELIMITER) : string()) + std::to_string(cell);
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
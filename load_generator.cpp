@@ -0,0 +1,141 @@
+#include "Headers.hpp"
+#include "utils.hpp"
+
+struct load_params {
+	string socket_path;
+	string filename;
+	uint n_gen;
+	uint n_clients;  // Concurrent connections
+	uint n_requests; // Sequential requests per connection
+};
+
+// Each client thread sends its requests one after the other and records their latencies
+struct client {
+	const load_params* params;
+	const string* request;
+	pthread_t thread;
+	vector<double> latencies; // Successful requests only, in microseconds
+	uint failures;
+};
+
+static inline load_params parse_input_args(int argc, char **argv);
+static inline void usage(const char* mes);
+static void* run_client(void* arg);
+static bool send_request(const string& socket_path, const string& request);
+static double percentile(const vector<double>& sorted, double p);
+
+/*--------------------------------------------------------------------------------
+										Main
+--------------------------------------------------------------------------------*/
+int main(int argc, char **argv) {
+
+    load_params params = parse_input_args(argc, argv);
+    string request = std::to_string(params.n_gen) + "\n";
+    for (auto &line: utils::read_lines(params.filename)) {
+        if (line.back() == '\r')
+            line.pop_back();
+        request += line + "\n";
+    }
+    request += "\n";
+
+    vector<client> clients(params.n_clients, client{&params, &request, pthread_t(), vector<double>(), 0});
+    auto start = std::chrono::system_clock::now();
+    for (auto &c: clients) {
+        pthread_create(&c.thread, nullptr, run_client, &c);
+    }
+    vector<double> latencies;
+    uint failures = 0;
+    for (auto &c: clients) {
+        pthread_join(c.thread, nullptr);
+        latencies.insert(latencies.end(), c.latencies.begin(), c.latencies.end());
+        failures += c.failures;
+    }
+    auto end = std::chrono::system_clock::now();
+    double total_time = (double)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::sort(latencies.begin(), latencies.end());
+    cout << "Requests: " << latencies.size() + failures << " (" << failures << " failed) in " << total_time << " us" << endl;
+    cout << "Throughput[1/s]: " << latencies.size() / (total_time / 1e6) << endl;
+    cout << "Latency[us]: p50=" << percentile(latencies, 0.5) << " p99=" << percentile(latencies, 0.99)
+         << " max=" << (latencies.empty() ? 0 : latencies.back()) << endl;
+    return failures ? 1 : 0;
+}
+/*--------------------------------------------------------------------------------
+							 Auxiliary Implementation
+--------------------------------------------------------------------------------*/
+static inline load_params parse_input_args(int argc, char **argv) {
+
+    if (argc != 6) // ./GameOfLifeLoadGen /tmp/gol.sock filename.txt 100 16 50
+        usage("Wrong number of arguments - expected 5");
+
+    load_params p;
+    p.socket_path = argv[1];
+    p.filename = argv[2];
+    p.n_gen = strtoul(argv[3], NULL, 10);
+    p.n_clients = strtoul(argv[4], NULL, 10);
+    p.n_requests = strtoul(argv[5], NULL, 10);
+
+    if (p.n_gen <= 0 || p.n_clients <= 0 || p.n_requests <= 0)
+        usage("Invalid number of generations/clients/requests (Required: integer >0)");
+    return p;
+}
+
+static inline void usage(const char* mes) {
+    cerr << "Usage Error : " << mes
+         << "\nUse format: ./GameOfLifeLoadGen <socket_path> <matrixfile.txt> <number_of_generations> <number_of_clients> <requests_per_client>\n";
+    exit(1);
+}
+
+static void* run_client(void* arg) {
+    client* c = (client*)arg;
+    for (uint i = 0; i < c->params->n_requests; ++i) {
+        auto start = std::chrono::system_clock::now();
+        bool ok = send_request(c->params->socket_path, *c->request);
+        auto end = std::chrono::system_clock::now();
+        if (ok)
+            c->latencies.push_back((double)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+        else
+            c->failures++;
+    }
+    return NULL;
+}
+
+// Sends a single request and reads the reply until the server closes the connection
+static bool send_request(const string& socket_path, const string& request) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return false;
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t sent = 0;
+    while (sent < request.size()) {
+        ssize_t n = send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            break;
+        sent += n;
+    }
+
+    string reply;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        reply.append(buffer, n);
+    }
+    close(fd);
+    return sent == request.size() && reply.compare(0, 3, "OK ") == 0;
+}
+
+static double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    size_t rank = (size_t)std::ceil(p * sorted.size());
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
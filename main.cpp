@@ -1,8 +1,12 @@
 #include "Game.hpp"
+#include "utils.hpp"
 
 static inline game_params parse_input_args(int argc, char **argv);
 static inline void usage(const char* mes);
-static void calc_and_append_statistics(uint n_threads, const vector<double>& gen_hist, const vector<double>& tile_hist);
+static inline region parse_region(const string& arg);
+static inline uint parse_number(const string& arg, const char* what);
+static void calc_and_append_statistics(uint n_threads, const vector<double>& gen_hist, const vector<double>& tile_hist,
+                                       long long page_faults, long long tlb_misses);
 
 /*--------------------------------------------------------------------------------
 										Main
@@ -12,7 +16,11 @@ int main(int argc, char **argv) {
     game_params params = parse_input_args(argc, argv);
     Game g(params);
     g.run();
-    calc_and_append_statistics(g.thread_num(), g.gen_hist(), g.tile_hist());
+    for (auto gen: params.seek_gens) {
+        if (!g.seek(gen))
+            cerr << "Generation " << gen << " is not in the history (see --history)" << endl;
+    }
+    calc_and_append_statistics(g.thread_num(), g.gen_hist(), g.tile_hist(), g.page_faults(), g.tlb_misses());
     return 0;
 }
 /*--------------------------------------------------------------------------------
@@ -20,33 +28,82 @@ int main(int argc, char **argv) {
 --------------------------------------------------------------------------------*/
 static inline game_params parse_input_args(int argc, char **argv) {
 
-    if (argc != 6) // ./gameoflife filename.txt 100 20 Y Y
-        usage("Wrong number of arguments - expected 5");
+    if (argc < 6) // ./gameoflife filename.txt 100 20 Y Y [--species species.csv] [--region 10,10,32,32] [--history 16 --seek 90]
+        usage("Wrong number of arguments - expected at least 5");
 
     game_params g;
     g.filename = argv[1];
-    g.n_gen = strtoul(argv[2], NULL, 10);
-    g.n_thread = strtoul(argv[3], NULL, 10);
+    g.n_gen = parse_number(argv[2], "number of generations");
+    g.n_thread = parse_number(argv[3], "number of threads");
 
     string inter = string(argv[4]);
     string print = string(argv[5]);
     g.interactive_on = (inter == "y" || inter == "Y") ? true : false;
     g.print_on = (print == "y" || print == "Y") ? true : false;
+    g.roi = region{0, 0, 0, 0};
+    g.history_depth = 0;
+
+    // Optional flags, following the 5 positional arguments
+    for (int i = 6; i < argc; ++i) {
+        string flag = string(argv[i]);
+        if (flag == "--species" && i + 1 < argc)
+            g.species_filename = argv[++i];
+        else if (flag == "--region" && i + 1 < argc)
+            g.roi = parse_region(argv[++i]);
+        else if (flag == "--history" && i + 1 < argc)
+            g.history_depth = parse_number(argv[++i], "history depth");
+        else if (flag == "--seek" && i + 1 < argc)
+            g.seek_gens.push_back(parse_number(argv[++i], "seek generation"));
+        else
+            usage((string("Unknown or incomplete option: ") + flag).c_str());
+    }
 
     if (g.n_gen <= 0 || g.n_thread <= 0)
         usage("Invalid number of generations/number of threads (Required: integer >0)");
+    if (!g.seek_gens.empty() && !g.print_on)
+        usage("--seek prints the kept generation, it requires output to screen (Y)");
     return g;
 }
 
 static inline void usage(const char* mes) {
     cerr << "Usage Error : " << mes
-         << "\nUse format: ./GameOfLife <matrixfile.txt> <number_of_generations> <number_of_threads> <Y/N> <Y/N>\n"
-         << "Last two are flags for (1) interactive mode , (2) output to screen\n";
+         << "\nUse format: ./GameOfLife <matrixfile.txt> <number_of_generations> <number_of_threads> <Y/N> <Y/N> [options]\n"
+         << "Last two are flags for (1) interactive mode , (2) output to screen\n"
+         << "Options: --species <file.csv> streams per generation births, deaths and population per specie\n"
+         << "         --region <row,col,height,width> prints only this window, simulating just the cells that can affect it\n"
+         << "                  (--species then counts only the window's cells)\n"
+         << "         --history <depth> keeps the last <depth> generations (0 is the initial board), sharing unchanged tiles\n"
+         << "         --seek <generation> prints a kept generation again after the run, may be repeated\n"
+         << "                  (requires output to screen)\n";
     exit(1);
 }
 
+static inline region parse_region(const string& arg) {
+    vector<string> fields = utils::split(arg, ',');
+    if (fields.size() != 4)
+        usage("Invalid region (Required: row,col,height,width)");
 
-static void calc_and_append_statistics(uint n_threads, const vector<double>& gen_hist, const vector<double>& tile_hist) {
+    uint values[4];
+    for (uint i = 0; i < 4; ++i) {
+        values[i] = parse_number(fields[i], "region value");
+    }
+
+    region r{values[0], values[1], values[2], values[3]};
+    if (r.height == 0 || r.width == 0)
+        usage("Invalid region size (Required: height, width >0)");
+    return r;
+}
+
+// Every numeric argument must be a plain non negative number that fits a uint, see utils::parse_uint
+static inline uint parse_number(const string& arg, const char* what) {
+    uint value = 0;
+    if (!utils::parse_uint(arg, value))
+        usage((string("Invalid ") + what + ": " + arg).c_str());
+    return value;
+}
+
+static void calc_and_append_statistics(uint n_threads, const vector<double>& gen_hist, const vector<double>& tile_hist,
+                                       long long page_faults, long long tlb_misses) {
 
     double total_time = (double)accumulate(gen_hist.begin(), gen_hist.end(), 0.0);
     double avg_gen_time = total_time / gen_hist.size();
@@ -54,19 +111,37 @@ static void calc_and_append_statistics(uint n_threads, const vector<double>& gen
     double gen_rate = gen_hist.size() / total_time;
     double tile_rate = tile_hist.size() / total_time;
 
+    const string header = "EffectiveThreadNum,GenNum,Gen_Rate[1/us],Avg_Gen_Time[us],Tile_Rate[1/us],Avg_Tile_Time[us],Total_Time[us],Page_Faults,DTLB_Misses";
     ifstream ifile(DEF_RESULTS_FILE_NAME);
     bool file_exists = ifile.good();
+    string existing_header;
+    getline(ifile, existing_header);
     ifile.close();
+    if (!existing_header.empty() && existing_header.back() == '\r')
+        existing_header.pop_back();
+
+    // A file written with other columns (e.g. before Page_Faults,DTLB_Misses were added) is kept aside, not mixed with.
+    // Earlier files kept aside are never overwritten: results.csv.old, then results.csv.old.1, results.csv.old.2 ...
+    if (file_exists && existing_header != header) {
+        string old_name = string(DEF_RESULTS_FILE_NAME) + ".old";
+        for (uint i = 1; ifstream(old_name).good(); ++i) {
+            old_name = string(DEF_RESULTS_FILE_NAME) + ".old." + std::to_string(i);
+        }
+        user_error(string("Failed to move ") + DEF_RESULTS_FILE_NAME + " to " + old_name,
+                   (rename(DEF_RESULTS_FILE_NAME, old_name.c_str()) == 0));
+        cerr << "Note: " << DEF_RESULTS_FILE_NAME << " had different columns, moved it to " << old_name << endl;
+        file_exists = false;
+    }
 
     std::ofstream results_file(DEF_RESULTS_FILE_NAME, std::ofstream::app | std::ofstream::out);
     if (!file_exists)
     {
-        results_file << "EffectiveThreadNum,GenNum,Gen_Rate[1/us],Avg_Gen_Time[us],Tile_Rate[1/us],Avg_Tile_Time[us],Total_Time[us]" << endl;
+        results_file << header << endl;
         // cout << "Successfully created results file: " << DEF_RESULTS_FILE_NAME << endl;
     }
 
     results_file << n_threads << "," << gen_hist.size() << "," << gen_rate << "," << avg_gen_time << "," << tile_rate
-                 << "," << avg_tile_time << "," << total_time << endl;
+                 << "," << avg_tile_time << "," << total_time << "," << page_faults << "," << tlb_misses << endl;
 
     results_file.close();
 }
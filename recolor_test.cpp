@@ -0,0 +1,105 @@
+#include "Recolor.hpp"
+
+#define TEST_ROUNDS 200 // Random boards compared against the reference recoloring
+#define TEST_CHANGE_WIDTH 8 // Columns per change flag
+
+static bool check_table();
+static bool check_rows();
+static uint reference_recolor(const Board& board, int i, int j);
+
+/*--------------------------------------------------------------------------------
+										Main
+--------------------------------------------------------------------------------*/
+// Checks the integer phase 2 recoloring against the original double based formula
+int main() {
+
+    bool table_ok = check_table();
+    bool rows_ok = check_rows();
+    cout << "Recolor table: " << (table_ok ? "OK" : "FAILED") << endl;
+    cout << "Recolor rows: " << (rows_ok ? "OK" : "FAILED") << endl;
+    return table_ok && rows_ok ? 0 : 1;
+}
+/*--------------------------------------------------------------------------------
+							 Auxiliary Implementation
+--------------------------------------------------------------------------------*/
+// Every reachable (alive, sum) pair, half-way cases included
+static bool check_table() {
+    const Recolor& recolor = Recolor::instance();
+    bool ok = true;
+    for (uint alive = 1; alive <= MAX_NEIGHBORHOOD; ++alive) {
+        for (uint sum = 0; sum <= MAX_NEIGHBORHOOD * MAX_SPECIE; ++sum) {
+            uint expected = (uint)round((double)sum / (double)alive);
+            if (recolor.at(alive, sum) != expected) {
+                cerr << "at(" << alive << ", " << sum << ") = " << (uint)recolor.at(alive, sum)
+                     << ", expected " << expected << endl;
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+static bool check_rows() {
+    const Recolor& recolor = Recolor::instance();
+    vector<uint> col_sum, col_cnt;
+    srand(1);
+    for (int round = 0; round < TEST_ROUNDS; ++round) {
+        uint height = 1 + rand() % 20;
+        uint width = 1 + rand() % 70;
+        uint dead_share = rand() % 10; // From sparse to dense boards
+        Board src, dst;
+        src.allocate(height, width);
+        dst.allocate(height, width);
+        src.prefault(0, height);
+        dst.prefault(0, height);
+        for (uint i = 0; i < height; ++i) {
+            for (uint j = 0; j < width; ++j) {
+                src[i][j] = (uint)(rand() % 10) < dead_share ? 0 : 1 + rand() % MAX_SPECIE;
+                dst[i][j] = rand() % 2 ? reference_recolor(src, i, j) : rand() % (MAX_SPECIE + 1); // Partly unchanged
+            }
+        }
+
+        for (uint i = 0; i < height; ++i) {
+            uint population[MAX_SPECIE + 1] = {0};
+            vector<uint> before(dst[i].data(), dst[i].data() + width);
+            vector<unsigned char> changed((width + TEST_CHANGE_WIDTH - 1) / TEST_CHANGE_WIDTH, 2);
+            recolor.recolor_row(src, dst[i], i, col_sum, col_cnt, population, 0, width,
+                                round % 2 ? changed.data() : nullptr, TEST_CHANGE_WIDTH);
+            vector<unsigned char> expected(changed.size(), 0);
+            for (uint j = 0; j < width; ++j) {
+                if (dst[i][j] != reference_recolor(src, i, j)) {
+                    cerr << "Row " << i << " of a " << height << "x" << width << " board differs at column " << j << endl;
+                    return false;
+                }
+                expected[j / TEST_CHANGE_WIDTH] |= dst[i][j] != before[j];
+            }
+            if (round % 2 && changed != expected) {
+                cerr << "Row " << i << " of a " << height << "x" << width << " board has wrong change flags" << endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The per cell phase 2 loop recolor_row replaced
+static uint reference_recolor(const Board& board, int i, int j) {
+    if (board[i][j] == 0)
+        return 0;
+    int low_bound = i-1 >= 0 ? i-1: 0;
+    int high_bound = i+1 < (int)board.size() ? i+1 : (int)board.size()-1;
+    int left_bound = j-1 >= 0 ? j-1: 0;
+    int right_bound = (int)board[i].size()-1 < j+1 ? (int)board[i].size()-1 : j+1;
+
+    double alive_neighbors = 0;
+    double sum = 0;
+    for (int k = low_bound; k <= high_bound; ++k) {
+        for (int l = left_bound; l <= right_bound; ++l) {
+            if (board[k][l] > 0) {
+                alive_neighbors++;
+                sum += board[k][l];
+            }
+        }
+    }
+    return round(sum / alive_neighbors);
+}
@@ -0,0 +1,49 @@
+#include "Server.hpp"
+
+static inline server_params parse_input_args(int argc, char **argv);
+static inline void usage(const char* mes);
+static void on_signal(int);
+
+static Server* server = nullptr;
+
+/*--------------------------------------------------------------------------------
+										Main
+--------------------------------------------------------------------------------*/
+int main(int argc, char **argv) {
+
+    server_params params = parse_input_args(argc, argv);
+    Server s(params);
+    server = &s;
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    s.serve(); // Returns once a signal stopped the server and the running simulations were cancelled
+    return 0;
+}
+/*--------------------------------------------------------------------------------
+							 Auxiliary Implementation
+--------------------------------------------------------------------------------*/
+static inline server_params parse_input_args(int argc, char **argv) {
+
+    if (argc != 3 && argc != 4) // ./GameOfLifeServer /tmp/gol.sock 8 [16]
+        usage("Wrong number of arguments - expected 2 or 3");
+
+    server_params p;
+    p.socket_path = argv[1];
+    p.n_thread = strtoul(argv[2], NULL, 10);
+    p.max_sessions = argc == 4 ? strtoul(argv[3], NULL, 10) : p.n_thread;
+
+    if (p.n_thread <= 0 || p.max_sessions <= 0)
+        usage("Invalid number of threads/number of simulations (Required: integer >0)");
+    return p;
+}
+
+static inline void usage(const char* mes) {
+    cerr << "Usage Error : " << mes
+         << "\nUse format: ./GameOfLifeServer <socket_path> <number_of_threads> [max_concurrent_simulations]\n"
+         << "All the simulations share the same <number_of_threads> threads, see Server.hpp for the protocol\n";
+    exit(1);
+}
+
+static void on_signal(int) {
+    server->stop();
+}
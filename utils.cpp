@@ -31,6 +31,18 @@ vector<string> utils::split(const string& s, char delimiter)
 	return tokens;
 }
 
+bool utils::parse_uint(const string& s, uint& value)
+{
+	// At most 10 digits, so strtoull cannot overflow before the UINT32_MAX check
+	if (s.empty() || s.size() > 10 || !std::all_of(s.begin(), s.end(), ::isdigit))
+		return false;
+	unsigned long long parsed = strtoull(s.c_str(), NULL, 10);
+	if (parsed > UINT32_MAX)
+		return false;
+	value = (uint)parsed;
+	return true;
+}
+
 /*--------------------------------------------------------------------------------
 								String Extentions
 --------------------------------------------------------------------------------*/
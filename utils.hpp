@@ -7,6 +7,8 @@ namespace utils {
 	vector<string> read_lines(const string& filename); 
 	// Returns a string array that contains the substrings in the string s that are delimited by the char delimiter
 	vector<string> split(const string& s, char delimiter); //Splits a string 
+	// Parses s as a plain decimal number that fits a uint (digits only: no sign, spaces or suffix). Returns false otherwise
+	bool parse_uint(const string& s, uint& value);
 }
 
 string repeat(string str, const size_t n);